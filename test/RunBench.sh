@@ -0,0 +1,136 @@
+#!/bin/bash
+
+##
+# This file provides a benchmark suite for the F4 implementation used in
+# parallelGBC. For all given inputs it computes the groebner basis for each
+# combination of threads, block size, simplify mode and sugar strategy and
+# records the best runtime of several repetitions together with the time of
+# each phase (taken from the telemetry of test-f4, see include/F4Logger.H).
+# If a baseline is given, each runtime is compared to it and a regression is
+# reported if it is slower by more than the tolerance.
+#
+# The suite is configured by the following environment variables, the
+# defaults are given in brackets:
+#
+#   INPUTS     names of the files in input/ without ".txt" (cyclic6 katsura7 eco7 sym3_5 rcyclic10)
+#   THREADS    the numbers of threads (1 2 4)
+#   BLOCKS     the block sizes (1024)
+#   SIMPLIFY   the simplify modes, 0, 1 or 2 (0)
+#   SUGAR      1 = with sugar, 0 = without sugar (1)
+#   REPS       the number of repetitions of each run (3)
+#   OUTPUT     the file the results are written to (bench_output.txt)
+#   BASELINE   the results of a previous run to compare with (none)
+#   TOLERANCE  the allowed slowdown against the baseline in percent (10)
+#
+# The results are written as CSV with one line per combination. Use e.g.
+#
+#   make bench INPUTS="cyclic7 katsura8" THREADS="1 8" BASELINE=base.txt
+#
+# Store the output of a run as baseline to compare later runs with it.
+#
+######
+#
+# parallelGBC is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# parallelGBC is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with parallelGBC.  If not, see <http://www.gnu.org/licenses/>.
+
+INPUTS=${INPUTS:-"cyclic6 katsura7 eco7 sym3_5 rcyclic10"}
+THREADS=${THREADS:-"1 2 4"}
+BLOCKS=${BLOCKS:-"1024"}
+SIMPLIFY=${SIMPLIFY:-"0"}
+SUGAR=${SUGAR:-"1"}
+REPS=${REPS:-3}
+OUTPUT=${OUTPUT:-bench_output.txt}
+TOLERANCE=${TOLERANCE:-10}
+
+# Message text if a run is slower than the baseline
+SLOWER="\033[1;31mregression\033[0m"
+# Message text if a run is within the tolerance
+PASSED="\033[0;32mok\033[0m"
+
+# The phases of a step, in the order of the telemetry columns
+PHASES="select symbolic sparse_to_dense preduce gauss extract update simplify"
+
+# Counter for the number of runs which are slower than the baseline
+RCOUNT=0;
+declare -i RCOUNT;
+
+# The telemetry of the current run and of the fastest run of a combination
+TMP=$(mktemp -d -t pgbc-bench.XXXXXX)
+trap "rm -rf $TMP" EXIT
+TELEMETRY=$TMP/run.csv
+BEST=$TMP/best.csv
+
+# Sum up the wall time of each phase over all steps of the telemetry file $1. The
+# columns 5, 7, ..., 19 are the wall times of the phases.
+function phases() {
+	awk -F, 'NR > 1 { for(i = 5; i <= 19; i += 2) { sum[i] += $i } }
+		END { s = ""; for(i = 5; i <= 19; i += 2) { s = s sprintf("%s%.6f", (i > 5 ? "," : ""), sum[i]) } print s }' "$1"
+}
+
+echo -n "input,threads,block,simplify,sugar,runtime" > $OUTPUT
+for p in $PHASES; do
+	echo -n ",$p" >> $OUTPUT
+done
+echo "" >> $OUTPUT
+
+for name in $INPUTS; do
+	i=input/${name}.txt
+	if [ ! -f $i ]; then
+		echo "$i does not exist" >&2
+		exit 1
+	fi
+	for c in $THREADS; do
+		for b in $BLOCKS; do
+			for s in $SIMPLIFY; do
+				for g in $SUGAR; do
+					key="${name},${c},${b},${s},${g}"
+					echo -en "${key} ... "
+					best=""
+					for r in $(seq 1 $REPS); do
+						# Verbosity 1 prints the overall runtime, the phases are written to the telemetry file
+						t=$(./test/test-f4.bin $i $c 1 0 $b $s $g --telemetry $TELEMETRY | awk -F'\t' '/^Runtime/ { print $2 }')
+						if [ -z "$t" ]; then
+							echo "failed" >&2
+							exit 1
+						fi
+						if [ -z "$best" ] || awk "BEGIN { exit !($t < $best) }"; then
+							best=$t
+							cp $TELEMETRY $BEST
+						fi
+					done
+					echo "${key},${best},$(phases $BEST)" >> $OUTPUT
+					echo -n "${best}s"
+					if [ -n "$BASELINE" ]; then
+						base=$(awk -F, -v key="$key" '{ k = $1 "," $2 "," $3 "," $4 "," $5; if(k == key) { print $6 } }' $BASELINE)
+						if [ -z "$base" ]; then
+							echo -n " (no baseline)"
+						elif awk "BEGIN { exit !($best > $base * (1 + $TOLERANCE / 100.0)) }"; then
+							echo -en " (baseline ${base}s) ${SLOWER}"
+							RCOUNT=$RCOUNT+1;
+						else
+							echo -en " (baseline ${base}s) ${PASSED}"
+						fi
+					fi
+					echo ""
+				done
+			done
+		done
+	done
+done
+
+echo -e "\nResults written to ${OUTPUT}"
+if [ $RCOUNT -gt 0 ]
+then
+	echo -e "\033[1;31m${RCOUNT} runs are more than ${TOLERANCE}% slower than the baseline.\033[0m"
+	exit 1
+fi
@@ -4,7 +4,9 @@
 # This file provides a test suite for the F4 implementation used in
 # parallelGBC. For all files in gb/ the script looks up the matching
 # file in input/ and computes the groebner basis and compares the
-# result with the pre-computed expected result.
+# result with the pre-computed expected result. The order of the
+# elements of the basis depends on the order in which the critical
+# pairs of a degree are reduced, so it is not compared.
 #
 ######
 #
@@ -46,6 +48,28 @@ function passed() {
 	echo -e ${PASSED}
 }
 
+# Print the elements of the groebner basis in the file $1 (or the standard input) one per line and sorted
+function elements() {
+	sed 's/, /\n/g' $1 | sort
+}
+
+# Compare the groebner basis on the standard input with the expected one in the file $1
+function same() {
+	elements | diff -q - <(elements $1) >> /dev/null
+}
+
+# Write the generators of the file $1 from $2 to $3 (inclusive) as one line
+function generators() {
+	sed 's/, /\n/g' $1 | sed -n "$2,$3p" | sed ':a;N;s/\n/, /;ta'
+}
+
+# Compute the input $1 modulo the prime $2 with the trace file $3 and print the groebner basis. Fails
+# if the trace status (printed with the verbosity 16) doesn't contain $4.
+function traced() {
+	local output=$(./test/test-f4.bin $1 2 16 1 1024 0 1 --modulus $2 --trace $3)
+	echo "$output" | grep -q "^Trace:.*$4" && echo "$output" | grep -v "^Degree:\|^Trace:"
+}
+
 # For 1 to 4 processors do ...
 for c in 1 2 4;
 	do
@@ -60,9 +84,130 @@ for c in 1 2 4;
 		# Output the input file name
 		echo -en "${f##"gb/"} ... ";
 		# Run the test
-		./test/test-f4.bin $i $c 0 1 | diff -q - $f >> /dev/null && passed || failed
+		./test/test-f4.bin $i $c 0 1 | same $f && passed || failed
+	done;
+done;
+
+# The same with the reducer using the A|B / C|D decomposition (see include/F4FLReducer.H)
+for c in 1 2 4;
+	do
+	echo -e "\nRunning tests with the FL reducer and \033[1;34m${c} core(s)\033[0m:"
+	for f in gb/*;
+	do
+		ACOUNT=$ACOUNT+1;
+		i=input/${f##"gb/"};
+		echo -en "${f##"gb/"} ... ";
+		./test/test-f4.bin $i $c 0 1 1024 0 1 --reducer 1 | same $f && passed || failed
+	done;
+done;
+
+# With the modulus 0 the groebner bases over the rationals in gb-rational/ are computed by the
+# multi-modular driver, with one and with two primes in flight
+for p in 1 2;
+	do
+	echo -e "\nRunning tests over the rationals with \033[1;34m${p} prime(s)\033[0m in flight:"
+	for f in gb-rational/*;
+	do
+		ACOUNT=$ACOUNT+1;
+		i=input/${f##"gb-rational/"};
+		echo -en "${f##"gb-rational/"} ... ";
+		./test/test-f4.bin $i 2 0 1 1024 0 1 --modulus 0 --primes $p | same $f && passed || failed
+	done;
+done;
+
+# Write a checkpoint every <interval> steps, then resume from the last one. It is written before the
+# last steps, so the resumed computation has to finish them.
+echo -e "\nRunning tests with \033[1;34mcheckpoints\033[0m:"
+for t in katsura8:5 cyclic6:10;
+	do
+	n=${t%%:*};
+	interval=${t##*:};
+	checkpoint=$(mktemp -u);
+	ACOUNT=$ACOUNT+1;
+	echo -en "${n}.txt (write) ... ";
+	./test/test-f4.bin input/${n}.txt 2 0 1 1024 0 1 --checkpoint $checkpoint --interval $interval | same gb/${n}.txt && [ -f $checkpoint ] && passed || failed
+	ACOUNT=$ACOUNT+1;
+	echo -en "${n}.txt (resume) ... ";
+	./test/test-f4.bin input/${n}.txt 2 0 1 1024 0 1 --checkpoint $checkpoint --interval $interval | same gb/${n}.txt && passed || failed
+	rm -f $checkpoint;
+done;
+
+# Record the trace of katsura7 and replay it for the same input, another prime and other coefficients.
+# The leading terms differ for the latter, so the replay falls back to the normal computation.
+echo -e "\nRunning tests with \033[1;34mtraces\033[0m:"
+trace=$(mktemp -u);
+changed=$(mktemp);
+sed 's/2\*x\[1\]\*x\[2\]/5*x[1]*x[2]/' input/katsura7.txt > $changed;
+ACOUNT=$ACOUNT+4;
+echo -en "katsura7.txt (record) ... ";
+./test/test-f4.bin input/katsura7.txt 2 0 1 1024 0 1 --trace $trace | same gb/katsura7.txt && [ -f $trace ] && passed || failed
+echo -en "katsura7.txt (replay) ... ";
+traced input/katsura7.txt 32003 $trace replayed | same gb/katsura7.txt && passed || failed
+echo -en "katsura7.txt (replay modulo 31991) ... ";
+traced input/katsura7.txt 31991 $trace replayed | same <(./test/test-f4.bin input/katsura7.txt 2 0 1 1024 0 1 --modulus 31991) && passed || failed
+echo -en "katsura7.txt (replay with other coefficients) ... ";
+traced $changed 32003 $trace failed | same <(./test/test-f4.bin $changed 2 0 1 1024 0 1) && passed || failed
+rm -f $trace $changed;
+
+# Compute the groebner basis of the first half of the generators and add the other half by F4::add().
+# F4::add() interreduces its result, so it is compared with the full input plus an empty file.
+echo -e "\nRunning tests with \033[1;34madded generators\033[0m:"
+first=$(mktemp);
+second=$(mktemp);
+empty=$(mktemp);
+for n in katsura7 cyclic6;
+	do
+	count=$(sed 's/, /\n/g' input/${n}.txt | grep -c .);
+	generators input/${n}.txt 1 $((count/2)) > $first;
+	generators input/${n}.txt $((count/2+1)) $count > $second;
+	ACOUNT=$ACOUNT+1;
+	echo -en "${n}.txt ... ";
+	./test/test-f4.bin $first 2 0 1 1024 0 1 --add $second | same <(./test/test-f4.bin input/${n}.txt 2 0 1 1024 0 1 --add $empty) && passed || failed
+done;
+rm -f $first $second $empty;
+
+# With a memory limit of 1 MB the blocks are made smaller and the matrices of katsura8 are spilled to
+# a file in the scratch directory, which has to be removed again. The spill is printed with verbosity 64.
+echo -e "\nRunning tests with a \033[1;34mmemory limit\033[0m:"
+scratch=$(mktemp -d);
+for r in 0 1;
+	do
+	ACOUNT=$ACOUNT+1;
+	echo -en "katsura8.txt (reducer ${r}) ... ";
+	output=$(./test/test-f4.bin input/katsura8.txt 2 64 1 1024 0 1 --reducer $r --memory-limit 1 --scratch $scratch);
+	echo "$output" | grep -q "matrix spilled" && echo "$output" | grep "x\[" | same gb/katsura8.txt && [ -z "$(ls -A $scratch)" ] && passed || failed
+done;
+rmdir $scratch;
+
+# Compute several systems, one per line, by the batch driver. The malformed system in the fifth line
+# yields an error line, the other lines have to be the groebner bases of the systems.
+echo -e "\nRunning tests with the \033[1;34mbatch driver\033[0m:"
+systems=$(mktemp);
+for n in cyclic4 cyclic5 katsura7 eco7;
+	do
+	cat input/${n}.txt;
+	echo;
+done > $systems;
+echo "x[1]*x[2] + , x[2]^" >> $systems;
+cat input/very-simple.txt >> $systems;
+for w in 1 2;
+	do
+	output=$(./test/test-batch.bin $systems $w);
+	l=1;
+	for n in cyclic4 cyclic5 katsura7 eco7 malformed very-simple;
+		do
+		ACOUNT=$ACOUNT+1;
+		echo -en "${n} (${w} workers) ... ";
+		if [ $n == malformed ]
+		then
+			echo "$output" | sed -n "${l}p" | grep -q "^Error: " && passed || failed
+		else
+			echo "$output" | sed -n "${l}p" | same gb/${n}.txt && passed || failed
+		fi
+		l=$((l+1));
 	done;
 done;
+rm -f $systems;
 
 # If not all tests passed print a statistic how many tests failed.
 if [ $FCOUNT -gt 0 ]